@@ -4,6 +4,7 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <memory>
 using namespace std;
 
 #define NEW "new"
@@ -21,46 +22,59 @@ private:
     vector<int> childPIDS;
     string processName;
     string processState;
-    int arrivalTime;        // The time at which a process arrives and becomes ready to be executed
+    long long arrivalTime;        // The time at which a process arrives and becomes ready to be executed
+    long long submitTime;         // The time at which the process was submitted (unchanged by re-admission)
     int burstTime;          // The time for which the process needs the CPU
     int remainingTime;
     int waitingTime;
     int priority;
+    long long deadline;           // Absolute deadline for real-time processes, -1 if none
+    int period;             // Release period of a real-time task, 0 if aperiodic
+    long long firstDispatchTime;    // First time the process got the CPU, -1 until then
+    long long completionTime;
     int ioDeviceID;         // Track which I/O device is allocated to this process
     bool isCompleted;
     bool waitingForIO;
 
-    void fork(int ppid, int current_time, int burst_time, int priority, bool waitingForIO) {
+    void fork(int ppid, long long current_time, int burst_time, int priority, bool waitingForIO, int relative_deadline, int period) {
         this->pid = pidCounter++;          // Assigning a unique PID
         this->ppid = ppid;                 // Created by the program
         this->childPIDS.clear();           // No children at fork
         this->processName = "Process" + to_string(this->pid);
         this->processState = NEW;          // Initial state
         this->arrivalTime = current_time;
+        this->submitTime = current_time;
         this->burstTime = burst_time;
         this->waitingTime = 0;
         this->priority = priority;
+        this->period = period;
+        if (relative_deadline <= 0) relative_deadline = period;     // implicit deadline = period
+        this->deadline = relative_deadline > 0 ? current_time + relative_deadline : -1;
+        this->firstDispatchTime = -1;
+        this->completionTime = -1;
         this->ioDeviceID = -1;             // No I/O device allocated initially
         this->isCompleted = false;
         this->waitingForIO = waitingForIO;
     }
 
 public:
-    PCB(int ppid, int current_time, int burst_time, int priority, bool waitingForIO) {
-        fork(ppid, current_time, burst_time, priority, waitingForIO);
+    PCB(int ppid, long long current_time, int burst_time, int priority, bool waitingForIO, int relative_deadline = 0, int period = 0) {
+        fork(ppid, current_time, burst_time, priority, waitingForIO, relative_deadline, period);
     }
 
     // Setters
-    void setArrivalTime(int time) { arrivalTime = time; }
+    void setArrivalTime(long long time) { arrivalTime = time; }
     void setBurstTime(int time) { burstTime = remainingTime = time; }
-    void setRemainingTime(int currentTime) { this->remainingTime = max(0, (burstTime - (currentTime - arrivalTime))); }
-    void setWaitingTime(int currentTime) { if (waitingForIO) { this->waitingTime = currentTime - this->arrivalTime; } }
+    void setRemainingTime(long long currentTime) { this->remainingTime = (int)max(0LL, (burstTime - (currentTime - arrivalTime))); }
+    void setWaitingTime(long long currentTime) { if (waitingForIO) { this->waitingTime = (int)(currentTime - this->arrivalTime); } }
     void setPriority(int p) { priority = p; }
     void setIODevicesAllocated(int deviceID) { 
         ioDeviceID = deviceID;
         waitingForIO = false;
     }
     void setWaitingForIO(bool status) { waitingForIO = status; }
+    void setCompletionTime(long long time) { completionTime = time; }
+    void markDispatched(long long time) { if (firstDispatchTime < 0) firstDispatchTime = time; }
     void completeProcess() { isCompleted = true; processState = TERMINATED; }
     void addChild(int childPID) { childPIDS.push_back(childPID); }
 
@@ -70,11 +84,25 @@ public:
     const vector<int>& getChildPIDs() const { return this->childPIDS; }
     string getProcessName() const { return this->processName; }
     string getProcessState() const { return this->processState; }
-    int getArrivalTime() const { return this->arrivalTime; }
+    long long getArrivalTime() const { return this->arrivalTime; }
+    long long getSubmitTime() const { return this->submitTime; }
     int getBurstTime() const { return this->burstTime; }
     int getRemainingTime() const { return this->remainingTime; }
     int getWaitingTime() const { return this->waitingTime; }
     int getPriority() const { return this->priority; }
+    long long getDeadline() const { return this->deadline; }
+    int getPeriod() const { return this->period; }
+    long long getFirstDispatchTime() const { return this->firstDispatchTime; }
+    long long getCompletionTime() const { return this->completionTime; }
+    bool isRealTime() const { return this->deadline >= 0; }
+    // Density of a real-time process: C / min(D, T), or C/D when aperiodic.
+    // Plain C/T is only a sufficient EDF test when D >= T.
+    double getDensity() const {
+        if (!isRealTime()) return 0;
+        long long relativeDeadline = deadline - submitTime;
+        long long window = period > 0 ? min(relativeDeadline, (long long)period) : relativeDeadline;
+        return window > 0 ? (double)burstTime / window : 1.0;
+    }
     bool getIsCompleted() const { return this->isCompleted; }
     bool getWaitingForIO() const { return this->waitingForIO; }
     int getIODevicesAllocated() const { return ioDeviceID; }
@@ -85,7 +113,7 @@ public:
     void increasePriority() { ++priority; }
 
     // generate child processes
-    PCB generateChildProcess(int current_time, int burst_time, int priority, bool waitingForIO) {
+    PCB generateChildProcess(long long current_time, int burst_time, int priority, bool waitingForIO) {
         PCB child(this->pid, current_time, burst_time, priority, waitingForIO);
         this->addChild(child.getPID());
         return child;
@@ -113,4 +141,20 @@ struct ComparePriority {
     }
 };
 
+// Oldest submission on top (FIFO among processes waiting for a device)
+struct CompareSubmitTime {
+    bool operator()(const shared_ptr<PCB>& a, const shared_ptr<PCB>& b) {
+        if (a->getSubmitTime() != b->getSubmitTime()) return a->getSubmitTime() > b->getSubmitTime();
+        return a->getPID() > b->getPID();
+    }
+};
+
+// Earliest deadline on top; ties broken by PID so the order is deterministic
+struct CompareDeadline {
+    bool operator()(const shared_ptr<PCB>& a, const shared_ptr<PCB>& b) {
+        if (a->getDeadline() != b->getDeadline()) return a->getDeadline() > b->getDeadline();
+        return a->getPID() > b->getPID();
+    }
+};
+
 #endif
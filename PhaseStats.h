@@ -0,0 +1,140 @@
+#ifndef PHASESTATS_H
+#define PHASESTATS_H
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+using namespace std;
+
+// Hot-path instrumentation. Build with -DSCHED_INSTRUMENTATION=0 to compile
+// every timer and counter out of the scheduler.
+//
+// Phase times are exclusive: a phase timed inside another (the run_* calls made
+// from dispatch) is subtracted from the enclosing one, so the phases add up to
+// the instrumented total. run_* call counts include the stopFlag=1 passes, which
+// return early but still snapshot the queue; chosen_* counts the algorithm
+// PolicyEngine actually picked.
+#ifndef SCHED_INSTRUMENTATION
+#define SCHED_INSTRUMENTATION 1
+#endif
+
+enum SchedPhase {
+    PHASE_ALLOCATE,
+    PHASE_AGING,
+    PHASE_METRICS,
+    PHASE_DISPATCH,
+    PHASE_DEALLOCATE,
+    PHASE_FCFS,
+    PHASE_SJF,
+    PHASE_PRIORITY,
+    PHASE_RR,
+    PHASE_EDF,
+    PHASE_COUNT
+};
+
+enum SchedCounter {
+    COUNTER_HEAP_PUSH,
+    COUNTER_HEAP_POP,
+    COUNTER_QUEUE_COPY,       // whole priority_queue copies / snapshots
+    COUNTER_DEVICE_SCAN,      // I/O devices examined while looking for a free one
+    COUNTER_DISPATCH,         // processes put on the CPU
+    COUNTER_CHOSE_FCFS,
+    COUNTER_CHOSE_SJF,
+    COUNTER_CHOSE_PRIORITY,
+    COUNTER_CHOSE_RR,
+    COUNTER_COUNT
+};
+
+class PhaseStats {
+private:
+    long long phaseNanos[PHASE_COUNT];
+    long long phaseCalls[PHASE_COUNT];
+    long long counters[COUNTER_COUNT];
+    class PhaseTimer* activeTimer;      // innermost running timer, for exclusive times
+
+    PhaseStats() : activeTimer(nullptr) { reset(); }
+
+    friend class PhaseTimer;
+
+public:
+    static PhaseStats& instance() {
+        static PhaseStats stats;
+        return stats;
+    }
+
+    void addPhase(SchedPhase phase, long long nanos) {
+        phaseNanos[phase] += nanos;
+        phaseCalls[phase]++;
+    }
+
+    void count(SchedCounter counter, long long n = 1) { counters[counter] += n; }
+
+    long long getPhaseNanos(SchedPhase phase) const { return phaseNanos[phase]; }
+    long long getPhaseCalls(SchedPhase phase) const { return phaseCalls[phase]; }
+    long long getCounter(SchedCounter counter) const { return counters[counter]; }
+
+    void reset() {
+        for (int i = 0; i < PHASE_COUNT; i++) phaseNanos[i] = phaseCalls[i] = 0;
+        for (int i = 0; i < COUNTER_COUNT; i++) counters[i] = 0;
+    }
+
+    void print(ostream& out) const {
+        static const char* phaseNames[PHASE_COUNT] = {
+            "allocate", "aging", "metrics", "dispatch", "deallocate", "run_fcfs", "run_sjf", "run_priority", "run_rr", "run_edf"
+        };
+        static const char* counterNames[COUNTER_COUNT] = {
+            "heap_push", "heap_pop", "queue_copy", "device_scan", "dispatch",
+            "chosen_fcfs", "chosen_sjf", "chosen_priority", "chosen_rr"
+        };
+        // Leave the caller's stream formatting as we found it
+        ios::fmtflags flags = out.flags();
+        streamsize precision = out.precision();
+        out << fixed << setprecision(1);
+        for (int i = 0; i < PHASE_COUNT; i++) {
+            out << "phase_" << phaseNames[i] << ": calls=" << phaseCalls[i]
+                << " total_us=" << phaseNanos[i] / 1000.0
+                << " avg_us=" << (phaseCalls[i] > 0 ? phaseNanos[i] / 1000.0 / phaseCalls[i] : 0) << "\n";
+        }
+        out.flags(flags);
+        out.precision(precision);
+        for (int i = 0; i < COUNTER_COUNT; i++) {
+            out << "count_" << counterNames[i] << ": " << counters[i] << "\n";
+        }
+    }
+};
+
+// Adds the lifetime of the enclosing scope, minus any nested timers, to a phase
+class PhaseTimer {
+private:
+    SchedPhase phase;
+    chrono::steady_clock::time_point start;
+    long long nestedNanos;
+    PhaseTimer* parent;
+
+public:
+    PhaseTimer(SchedPhase p) : phase(p), start(chrono::steady_clock::now()), nestedNanos(0) {
+        PhaseStats& stats = PhaseStats::instance();
+        parent = stats.activeTimer;
+        stats.activeTimer = this;
+    }
+    ~PhaseTimer() {
+        long long elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+        PhaseStats& stats = PhaseStats::instance();
+        stats.addPhase(phase, elapsed - nestedNanos);
+        if (parent) parent->nestedNanos += elapsed;
+        stats.activeTimer = parent;
+    }
+};
+
+#define SCHED_CONCAT_INNER(a, b) a##b
+#define SCHED_CONCAT(a, b) SCHED_CONCAT_INNER(a, b)
+
+#if SCHED_INSTRUMENTATION
+#define SCHED_TIME_PHASE(phase) PhaseTimer SCHED_CONCAT(phaseTimer_, __LINE__)(phase)
+#define SCHED_COUNT(counter, n) PhaseStats::instance().count(counter, n)
+#else
+#define SCHED_TIME_PHASE(phase) ((void)0)
+#define SCHED_COUNT(counter, n) ((void)0)
+#endif
+
+#endif
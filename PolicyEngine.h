@@ -5,6 +5,7 @@
 #include <memory>
 #include "PCB.h"
 #include "Scheduler.h"
+#include "PhaseStats.h"
 using namespace std;
 
 // System metrics structure
@@ -33,6 +34,8 @@ private:
         int totalProcesses = 0;
 
         priority_queue<shared_ptr<PCB>, vector<shared_ptr<PCB>>, ComparePriority> tempQueue = readyQueue;
+        SCHED_COUNT(COUNTER_QUEUE_COPY, 1);
+        SCHED_COUNT(COUNTER_HEAP_POP, tempQueue.size());
         while (!tempQueue.empty()) {
             auto process = tempQueue.top();
             totalBurstTime += process->getBurstTime();
@@ -49,6 +52,8 @@ private:
 
     void applyAging(priority_queue<shared_ptr<PCB>, vector<shared_ptr<PCB>>, ComparePriority>& readyQueue) {
         priority_queue<shared_ptr<PCB>, vector<shared_ptr<PCB>>, ComparePriority> tempQueue;
+        SCHED_COUNT(COUNTER_HEAP_POP, readyQueue.size());
+        SCHED_COUNT(COUNTER_HEAP_PUSH, readyQueue.size());
         
         while (!readyQueue.empty()) {
             shared_ptr<PCB> process = readyQueue.top();
@@ -68,6 +73,7 @@ private:
         }
         
         readyQueue = tempQueue;
+        SCHED_COUNT(COUNTER_QUEUE_COPY, 1);
     }
 
 public:
@@ -76,12 +82,21 @@ public:
     void chooseSchedulingAlgorithm(priority_queue<shared_ptr<PCB>, vector<shared_ptr<PCB>>, ComparePriority>& readyQueue,
          int timeQuantum) {
         // Applying aging bfr choosing algo; avoiding starvation
-        applyAging(readyQueue);
-        SystemMetrics metrics = calculateSystemMetrics(readyQueue);	// Calc sys metrics for scheduling
+        {
+            SCHED_TIME_PHASE(PHASE_AGING);
+            applyAging(readyQueue);
+        }
+        SystemMetrics metrics;
+        {
+            SCHED_TIME_PHASE(PHASE_METRICS);
+            metrics = calculateSystemMetrics(readyQueue);	// Calc sys metrics for scheduling
+        }
+        SCHED_TIME_PHASE(PHASE_DISPATCH);        // excludes the run_* phases nested below
         cout << "Avg Burst Time: " << metrics.avgBurstTime << "\nQueue Size: " << metrics.queueSize << "\n% High Priority: " << metrics.percentHighPriority << endl;
         
         if (metrics.queueSize > THRESH_QUEUE_SIZE) {
             cout << "Running Round Robin Scheduling ..." << endl;
+            SCHED_COUNT(COUNTER_CHOSE_RR, 1);
             scheduler->runRoundRobin(readyQueue, 0, timeQuantum);
             scheduler->runSJF(readyQueue, 1);
             scheduler->runPriority(readyQueue, 1);
@@ -89,6 +104,7 @@ public:
         }
         else if (metrics.avgBurstTime < THRESH_BURST_TIME) {
             cout << "Running SJF Scheduling ..." << endl;
+            SCHED_COUNT(COUNTER_CHOSE_SJF, 1);
             scheduler->runSJF(readyQueue, 0);
             scheduler->runRoundRobin(readyQueue, 1, timeQuantum);
             scheduler->runPriority(readyQueue, 1);
@@ -96,6 +112,7 @@ public:
         }
         else if (metrics.percentHighPriority > THRESH_HIGH_PRIORITY) {
             cout << "Running Priority Scheduling ..." << endl;
+            SCHED_COUNT(COUNTER_CHOSE_PRIORITY, 1);
             scheduler->runPriority(readyQueue, 0);
             scheduler->runSJF(readyQueue, 1);
             scheduler->runRoundRobin(readyQueue, 1, timeQuantum);
@@ -103,6 +120,7 @@ public:
         }
         else {
             cout << "Running FCFS Scheduling ..." << endl;
+            SCHED_COUNT(COUNTER_CHOSE_FCFS, 1);
             scheduler->runFCFS(readyQueue, 0);
             scheduler->runSJF(readyQueue, 1);
             scheduler->runRoundRobin(readyQueue, 1, timeQuantum);
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include "PCB.h"
 #include "SimulationClock.h"
+#include "PhaseStats.h"
 using namespace std;
 
 class Scheduler {
@@ -19,6 +20,8 @@ private:
     vector<shared_ptr<PCB>> snapshotQueue(const priority_queue<shared_ptr<PCB>, vector<shared_ptr<PCB>>, ComparePriority>& q) {
         vector<shared_ptr<PCB>> vec;
         auto temp = q;
+        SCHED_COUNT(COUNTER_QUEUE_COPY, 1);
+        SCHED_COUNT(COUNTER_HEAP_POP, temp.size());
         while (!temp.empty()) {
             vec.push_back(temp.top());
             temp.pop();
@@ -32,10 +35,14 @@ public:
 
     void runFCFS(priority_queue<shared_ptr<PCB>, vector<shared_ptr<PCB>>, ComparePriority>& readyQueue, bool stopFlag) 
     {
+        SCHED_TIME_PHASE(PHASE_FCFS);
         for (auto& process : snapshotQueue(readyQueue)) {
             if (stopFlag || process->getIsCompleted()) return; //if stopflag = 1 ... just return
 
             process->updateProcessState(RUNNING);
+
+            process->markDispatched(clock->getCurrentTime());
+            SCHED_COUNT(COUNTER_DISPATCH, 1);
             int execTime = process->getRemainingTime();
 
             cout << "[FCFS] PID " << process->getPID() << " executing for " << execTime << "ms\n";
@@ -50,15 +57,24 @@ public:
 
     void runPriority(priority_queue<shared_ptr<PCB>, vector<shared_ptr<PCB>>, ComparePriority>& readyQueue, bool stopFlag) 
     {
+        SCHED_TIME_PHASE(PHASE_PRIORITY);
         if (!stopFlag) {
             priority_queue<shared_ptr<PCB>, vector<shared_ptr<PCB>>, ComparePriority> tempQueue;
             while (!readyQueue.empty()) {
                 auto process = readyQueue.top();
                 readyQueue.pop();
+                SCHED_COUNT(COUNTER_HEAP_POP, 1);
 
+                // Completed processes stay in the queue so deallocateResources can release
+                // their I/O devices and retire them
+                tempQueue.push(process);
+                SCHED_COUNT(COUNTER_HEAP_PUSH, 1);
                 if (stopFlag || process->getIsCompleted()) continue;
 
                 process->updateProcessState(RUNNING);
+
+                process->markDispatched(clock->getCurrentTime());
+                SCHED_COUNT(COUNTER_DISPATCH, 1);
                 int execTime = process->getRemainingTime();
 
                 cout << "[PRIO] PID " << process->getPID() << " executing for " << execTime << "ms\n";
@@ -67,22 +83,19 @@ public:
                 process->completeProcess();
 
                 cout << "[PRIO] PID " << process->getPID() << " completed at time " << clock->getCurrentTime() << "ms\n";
-
-                // Update the process in the tempQueue
-                if (!process->getIsCompleted()) {
-                    tempQueue.push(process);
-                }
                 clock->tick();
             }
 
             // Swap back the updated queue
             readyQueue = tempQueue;
+            SCHED_COUNT(COUNTER_QUEUE_COPY, 1);
         }
     }
 
 
     void runSJF(priority_queue<shared_ptr<PCB>, vector<shared_ptr<PCB>>, ComparePriority>& readyQueue, bool stopFlag) 
     {
+        SCHED_TIME_PHASE(PHASE_SJF);
         auto processes = snapshotQueue(readyQueue);
         // to sort processes list according to brust time
         sort(processes.begin(), processes.end(), [](const auto& a, const auto& b) { 
@@ -93,6 +106,9 @@ public:
             if (stopFlag || proc->getIsCompleted()) return;
 
             proc->updateProcessState(RUNNING);
+
+            proc->markDispatched(clock->getCurrentTime());
+            SCHED_COUNT(COUNTER_DISPATCH, 1);
             int execTime = proc->getRemainingTime();
 
             cout << "[SJF] PID " << proc->getPID() << " executing for " << execTime << "ms\n";
@@ -105,10 +121,38 @@ public:
         }
     }
 
+    // Runs the real-time process with the earliest deadline to completion and returns it
+    shared_ptr<PCB> runEDF(priority_queue<shared_ptr<PCB>, vector<shared_ptr<PCB>>, CompareDeadline>& realTimeQueue)
+    {
+        SCHED_TIME_PHASE(PHASE_EDF);
+        auto process = realTimeQueue.top();
+        realTimeQueue.pop();
+        SCHED_COUNT(COUNTER_HEAP_POP, 1);
+
+        process->updateProcessState(RUNNING);
+
+        process->markDispatched(clock->getCurrentTime());
+        SCHED_COUNT(COUNTER_DISPATCH, 1);
+        int execTime = process->getRemainingTime();
+
+        cout << "[EDF] PID " << process->getPID() << " (deadline " << process->getDeadline() << "ms) executing for " << execTime << "ms\n";
+        clock->tick(execTime);
+        process->decrementRemainingTime(execTime);
+        process->setCompletionTime(clock->getCurrentTime());
+        process->completeProcess();
+
+        cout << "[EDF] PID " << process->getPID() << " completed at time " << clock->getCurrentTime() << "ms\n";
+        clock->tick();
+        return process;
+    }
+
     void runRoundRobin(priority_queue<shared_ptr<PCB>, vector<shared_ptr<PCB>>, ComparePriority>& readyQueue, bool stopFlag, int timeQuantum) 
     {
+        SCHED_TIME_PHASE(PHASE_RR);
         deque<shared_ptr<PCB>> rrQueue;
         priority_queue<shared_ptr<PCB>, vector<shared_ptr<PCB>>, ComparePriority> temp = readyQueue;
+        SCHED_COUNT(COUNTER_QUEUE_COPY, 1);
+        SCHED_COUNT(COUNTER_HEAP_POP, temp.size());
         // copying the priority_queue to the double ended queue
         while (!temp.empty()) {
             rrQueue.push_back(temp.top());
@@ -121,6 +165,8 @@ public:
 
             int execTime = min(proc->getRemainingTime(), timeQuantum);
             proc->updateProcessState(RUNNING);
+            proc->markDispatched(clock->getCurrentTime());
+            SCHED_COUNT(COUNTER_DISPATCH, 1);
 
             cout << "[RR] PID " << proc->getPID() << " running for " << execTime << "ms\n";
             clock->tick(execTime);
@@ -5,7 +5,7 @@ using namespace std;
 
 class SimulationClock {
 private:
-	int currentTime;
+	long long currentTime;     // 64-bit so long-running daemons don't wrap
 
 public:
 	SimulationClock() : currentTime(0) {}
@@ -14,11 +14,11 @@ public:
 		currentTime++;
 	}
 
-	void tick(int time) {
+	void tick(long long time) {
 		currentTime += time;
 	}
 
-	int getCurrentTime() const {
+	long long getCurrentTime() const {
 		return currentTime;
 	}
 
@@ -9,11 +9,15 @@
 #include <queue>
 #include <vector>
 #include <memory>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
 #include "PCB.h"
 #include "Scheduler.h"
 #include "SimulationClock.h"
 #include "PolicyEngine.h"
 #include "IOdevices.h"
+#include "PhaseStats.h"
 using namespace std;
 
 class SimulationManager {
@@ -21,12 +25,59 @@ private:
 	// System resources
 	vector<IOdevices> ioDevices;  // true means device is available
 	list<shared_ptr<PCB>> jobQueue;      
-	priority_queue<shared_ptr<PCB>, vector<shared_ptr<PCB>>, ComparePriority> deviceQueue;
+	priority_queue<shared_ptr<PCB>, vector<shared_ptr<PCB>>, CompareSubmitTime> deviceQueue;      // oldest submission first
 	priority_queue<shared_ptr<PCB>, vector<shared_ptr<PCB>>, ComparePriority> readyQueue;
+	priority_queue<shared_ptr<PCB>, vector<shared_ptr<PCB>>, CompareDeadline> realTimeQueue;   // EDF, runs before readyQueue
+	priority_queue<shared_ptr<PCB>, vector<shared_ptr<PCB>>, CompareDeadline> realTimeDeviceQueue;   // served before deviceQueue
 	Scheduler* scheduler;
 	SimulationClock clock;
 	PolicyEngine* policyEngine;
 
+	// Admission control: submissions are refused once this many processes are waiting
+	// to be retired (jobQueue + deviceQueue + ready queues)
+	const size_t MAX_BACKLOG = 1000;
+
+	// EDF admission control: total density of live real-time processes may not exceed this
+	const double RT_DENSITY_BOUND = 1.0;
+
+	// Phase timers and counters are dumped every this many scheduling steps
+	const long long PHASE_DUMP_INTERVAL = 1000;
+	long long steps = 0;
+
+	// Terminated PCBs are folded into these aggregates and released, so memory
+	// does not grow with the number of processes that have ever run
+	struct RetiredStats {
+		long long completed = 0;
+		long long totalBurstTime = 0;
+		long long totalTurnaround = 0;     // submit -> completion, in simulation time
+		long long maxTurnaround = 0;
+		long long totalQueueLatency = 0;   // submit -> first dispatch, in simulation time
+		long long maxQueueLatency = 0;
+	};
+
+	struct AdmissionStats {
+		long long batches = 0;
+		long long submitted = 0;
+		long long accepted = 0;
+		long long rejected = 0;
+		long long malformed = 0;
+	};
+
+	struct RealTimeStats {
+		long long admitted = 0;
+		long long rejected = 0;
+		long long completed = 0;
+		long long deadlineMisses = 0;
+		long long totalLateness = 0;       // completion - deadline; negative when finished early
+		long long maxLateness = 0;
+		double density = 0;                // reserved by admitted, not yet completed processes
+	};
+
+	RetiredStats retired;
+	AdmissionStats admission;
+	RealTimeStats realTime;
+	chrono::steady_clock::time_point startTime;
+
 	// System metrics structure
 	struct SystemMetrics {
 		double avgBurstTime;
@@ -57,8 +108,72 @@ private:
 		return metrics;
 	}
 
+	// Real-time processes waiting for I/O get the free devices first, earliest deadline first
+	void allocateRealTimeDevices() {
+		while (!realTimeDeviceQueue.empty()) {
+			auto process = realTimeDeviceQueue.top();
+			bool ioAvailable = false;
+			for (auto& device : ioDevices) {
+				SCHED_COUNT(COUNTER_DEVICE_SCAN, 1);
+				if (device.getAvailability()) {
+					ioAvailable = true;
+					device.setAvailability(false);
+					process->setIODevicesAllocated(device.getDeviceID());
+					break;
+				}
+			}
+			if (!ioAvailable) {
+				cout << "No I/O device available for real-time PID " << process->getPID() << endl;
+				break;
+			}
+			process->setArrivalTime(clock.getCurrentTime());
+			process->updateProcessState(READY);
+			enqueueReady(process);
+			cout << "Moved PID " << process->getPID() << " from real-time deviceQueue to realTimeQueue\n";
+			realTimeDeviceQueue.pop();
+			SCHED_COUNT(COUNTER_HEAP_POP, 1);
+		}
+	}
+
+	// Processes already waiting in deviceQueue get freed devices before new jobQueue arrivals,
+	// so a steady stream of submissions cannot starve them
+	void allocateWaitingDevices() {
+		while (!deviceQueue.empty()) {
+			bool ioAvailable = false;
+			for (auto& device : ioDevices) {
+				SCHED_COUNT(COUNTER_DEVICE_SCAN, 1);
+				if (device.getAvailability()) {
+					ioAvailable = true;
+					device.setAvailability(false);
+					deviceQueue.top()->setIODevicesAllocated(device.getDeviceID());
+					break;
+				}
+			}
+
+			if (ioAvailable) {
+				deviceQueue.top()->setArrivalTime(clock.getCurrentTime());
+				deviceQueue.top()->updateProcessState(READY);
+				enqueueReady(deviceQueue.top());
+				cout << "Moved PID " << deviceQueue.top()->getPID() << " from deviceQueue to readyQueue\n";
+				deviceQueue.pop();
+				SCHED_COUNT(COUNTER_HEAP_POP, 1);
+			}
+			else {
+				cout << "No I/O device available for PID " << deviceQueue.top()->getPID() << endl;
+				break;
+			}
+		}
+	}
+
 	// If the process needs IO devices and IO devices are not available then move it to device queue
 	void allocateResources() {
+		SCHED_TIME_PHASE(PHASE_ALLOCATE);
+		allocateRealTimeDevices();
+		allocateWaitingDevices();
+
+		// Real-time jobs claim devices ahead of ordinary jobs submitted before them
+		stable_partition(jobQueue.begin(), jobQueue.end(), [](const shared_ptr<PCB>& p) { return p->isRealTime(); });
+
 		// Iterating over jobQueue
 		for (auto it = jobQueue.begin(); it != jobQueue.end();) {
 
@@ -66,13 +181,14 @@ private:
 				bool ioAllocated = false;
 
 				for (auto& ioDevice : ioDevices) {
+					SCHED_COUNT(COUNTER_DEVICE_SCAN, 1);
 					if (ioDevice.getAvailability()) {
 						ioDevice.setAvailability(false);
 						(*it)->setIODevicesAllocated(ioDevice.getDeviceID());
 						(*it)->setWaitingForIO(false);
 						(*it)->setArrivalTime(clock.getCurrentTime());
 						(*it)->updateProcessState(READY);
-					    readyQueue.push(*it);
+					    enqueueReady(*it);
 						// Removing process from jobQueue
 						cout << "Moved PID " << (*it)->getPID() << " from jobQueue to readyQueue (I/O Allocated)\n";
 						it = jobQueue.erase(it);
@@ -83,7 +199,13 @@ private:
 
 				// If IO devices are not available then pcb moved to deviceQueue
 				if (!ioAllocated) {
-					deviceQueue.push(*it);
+					if ((*it)->isRealTime()) {
+						realTimeDeviceQueue.push(*it);
+					}
+					else {
+						deviceQueue.push(*it);
+					}
+					SCHED_COUNT(COUNTER_HEAP_PUSH, 1);
 					(*it)->setWaitingForIO(true);
 					(*it)->updateProcessState(WAITING);
 					cout << "Moved PID " << (*it)->getPID() << " to device queue (waiting for I/O)" << endl;
@@ -95,35 +217,33 @@ private:
 			else {
 				(*it)->setArrivalTime(clock.getCurrentTime());
 				(*it)->updateProcessState(READY);
-				readyQueue.push(*it);
+				enqueueReady(*it);
 				// Removing process from jobQueue
 				cout << "Moved PID " << (*it)->getPID() << " to ready queue (no I/O needed)" << endl;
 				it = jobQueue.erase(it);
 			}
 		}
+	}
 
-		if (!deviceQueue.empty() && jobQueue.empty()) {
-			priority_queue<shared_ptr<PCB>, vector<shared_ptr<PCB>>, ComparePriority> tempDeviceQueue;
-			while (!deviceQueue.empty()) {
-				bool ioAvailable = false;
-				for (auto& device : ioDevices) {
-					if (device.getAvailability()) {
-						ioAvailable = true;
-						device.setAvailability(false);
-						deviceQueue.top()->setIODevicesAllocated(device.getDeviceID());
-						break;
-					}
-				}
+	// Real-time processes go to the deadline-ordered queue, everything else to readyQueue
+	void enqueueReady(const shared_ptr<PCB>& process) {
+		if (process->isRealTime()) {
+			realTimeQueue.push(process);
+		}
+		else {
+			readyQueue.push(process);
+		}
+		SCHED_COUNT(COUNTER_HEAP_PUSH, 1);
+	}
 
-				if (ioAvailable) {
-					deviceQueue.top()->setArrivalTime(clock.getCurrentTime());
-					deviceQueue.top()->updateProcessState(READY);
-					readyQueue.push(deviceQueue.top());
-					cout << "Moved PID " << deviceQueue.top()->getPID() << " from deviceQueue to readyQueue\n";
-					deviceQueue.pop();
-				}
-				else {
-					cout << "No I/O device available for PID " << deviceQueue.top()->getPID() << endl;
+	void releaseIODevice(const shared_ptr<PCB>& process) {
+		int deviceID = process->getIODevicesAllocated();
+		if (deviceID != -1) {
+			for (auto& device : ioDevices) {
+				SCHED_COUNT(COUNTER_DEVICE_SCAN, 1);
+				if (device.getDeviceID() == deviceID) {
+					device.setAvailability(true);
+					cout << "Released I/O device " << device.getDeviceID() << " from completed process " << process->getPID() << endl;
 					break;
 				}
 			}
@@ -132,30 +252,69 @@ private:
 
 	// Deallocate resources from completed processes
 	void deallocateResources() {
+		SCHED_TIME_PHASE(PHASE_DEALLOCATE);
 		// Handle completed processes in readyQueue
 		priority_queue<shared_ptr<PCB>, vector<shared_ptr<PCB>>, ComparePriority> tempReadyQueue;
 		while (!readyQueue.empty()) {
 			auto process = readyQueue.top();
 			readyQueue.pop();
+			SCHED_COUNT(COUNTER_HEAP_POP, 1);
 
 			if (process->getIsCompleted()) {
-				int deviceID = process->getIODevicesAllocated();
-				if (deviceID != -1) {
-					for (auto& device : ioDevices) {
-						if (device.getDeviceID() == deviceID) {
-							device.setAvailability(true);
-							cout << "Released I/O device " << device.getDeviceID() << " from completed process " << process->getPID() << endl;
-							break;
-						}
-					}
-				}
+				releaseIODevice(process);
+				retireProcess(process);
 				cout << "Process " << process->getPID() << " completed and deallocated.\n";
 			}
 			else {
 				tempReadyQueue.push(process);
+				SCHED_COUNT(COUNTER_HEAP_PUSH, 1);
 			}
 		}
 		readyQueue = tempReadyQueue;
+		SCHED_COUNT(COUNTER_QUEUE_COPY, 1);
+	}
+
+	// Folds a terminated process into the retired aggregates
+	void retireProcess(const shared_ptr<PCB>& process) {
+		long long turnaround = clock.getCurrentTime() - process->getSubmitTime();
+		retired.completed++;
+		retired.totalBurstTime += process->getBurstTime();
+		retired.totalTurnaround += turnaround;
+		retired.maxTurnaround = max(retired.maxTurnaround, turnaround);
+
+		long long dispatched = process->getFirstDispatchTime() >= 0 ? process->getFirstDispatchTime() : clock.getCurrentTime();
+		long long queueLatency = dispatched - process->getSubmitTime();
+		retired.totalQueueLatency += queueLatency;
+		retired.maxQueueLatency = max(retired.maxQueueLatency, queueLatency);
+	}
+
+	// Releases a finished real-time process and records whether it met its deadline
+	void deallocateRealTimeProcess(const shared_ptr<PCB>& process) {
+		long long lateness = process->getCompletionTime() - process->getDeadline();
+		if (realTime.completed == 0 || lateness > realTime.maxLateness) realTime.maxLateness = lateness;
+		realTime.completed++;
+		realTime.totalLateness += lateness;
+		realTime.density = max(0.0, realTime.density - process->getDensity());
+		if (lateness > 0) {
+			realTime.deadlineMisses++;
+			cout << "[EDF] PID " << process->getPID() << " missed its deadline by " << lateness << "ms\n";
+		}
+		releaseIODevice(process);
+		retireProcess(process);
+		cout << "Process " << process->getPID() << " completed and deallocated.\n";
+	}
+
+	// Density-based admission test for EDF (sum of C/min(D,T) must stay within the bound)
+	bool admitRealTime(const PCB& process) {
+		if (realTime.density + process.getDensity() > RT_DENSITY_BOUND) {
+			realTime.rejected++;
+			cerr << "Rejected real-time process " << process.getPID() << ": density "
+				<< realTime.density + process.getDensity() << " exceeds " << RT_DENSITY_BOUND << endl;
+			return false;
+		}
+		realTime.density += process.getDensity();
+		realTime.admitted++;
+		return true;
 	}
 
 	// loads processes from a file into jobQueue
@@ -171,6 +330,7 @@ private:
 		while (getline(programReader, processes)) {
 			try {
 				PCB process = createPCBFromProgram(processes);
+				if (process.isRealTime() && !admitRealTime(process)) continue;
 				shared_ptr<PCB> ptr_to_PCB = make_shared<PCB>(process);
 				jobQueue.push_back(ptr_to_PCB);
 			} catch (const exception& e) {
@@ -183,15 +343,39 @@ private:
 	}
 
 	PCB createPCBFromProgram(string processes){
-		int ppid, current_time, burst_time, priority;
+		int ppid, burst_time, priority;
+		long long current_time;
+		int relative_deadline = 0, period = 0;
 		bool waitingForIO;
 		// Parse line and create PCB
-		// Implementation depends on your process file format
+		// Format: ppid burst priority waitingForIO [deadline [period]]
 		stringstream ss(processes);
 		ss >> ppid >> burst_time >> priority >> waitingForIO;
+		if (ss.fail() || burst_time < 0) {
+			throw invalid_argument("malformed process entry: \"" + processes + "\"");
+		}
+		// Optional real-time fields; a deadline of 0 with a period means deadline = period.
+		// Anything present must parse as a whole integer, and at most two may follow.
+		vector<int> realTimeFields;
+		string field;
+		while (ss >> field) {
+			size_t used = 0;
+			int value = 0;
+			try {
+				value = stoi(field, &used);
+			} catch (const exception&) {
+				used = 0;
+			}
+			if (used != field.size() || value < 0 || realTimeFields.size() == 2) {
+				throw invalid_argument("malformed process entry: \"" + processes + "\"");
+			}
+			realTimeFields.push_back(value);
+		}
+		if (realTimeFields.size() > 0) relative_deadline = realTimeFields[0];
+		if (realTimeFields.size() > 1) period = realTimeFields[1];
 		current_time = clock.getCurrentTime();
-		PCB process(ppid, current_time, burst_time, priority, waitingForIO);
-		process.setRemainingTime(burst_time);  // Set remaining time equal to burst time
+		PCB process(ppid, current_time, burst_time, priority, waitingForIO, relative_deadline, period);
+		process.setBurstTime(burst_time);  // Set remaining time equal to burst time
 		return process;
 	}
 
@@ -205,49 +389,162 @@ private:
 	}
 
 public:
-	SimulationManager() {
+	SimulationManager(bool loadProgram = true) : startTime(chrono::steady_clock::now()) {
 		scheduler = new Scheduler(&clock);
 		policyEngine = new PolicyEngine(scheduler);
-		loadProcesses();
+		if (loadProgram) {
+			loadProcesses();
+		}
 		loadIOdevices();
 	}
 
+	// Admits one batch of job lines (same format as Program.txt) into jobQueue.
+	// Lines beyond MAX_BACKLOG are rejected; returns the number accepted.
+	int submitJobs(const vector<string>& lines) {
+		int accepted = 0;
+		admission.batches++;
+		for (const auto& line : lines) {
+			admission.submitted++;
+			if (!isAcceptingJobs()) {
+				admission.rejected++;
+				continue;
+			}
+			try {
+				PCB process = createPCBFromProgram(line);
+				if (process.isRealTime() && !admitRealTime(process)) {
+					admission.rejected++;
+					continue;
+				}
+				jobQueue.push_back(make_shared<PCB>(process));
+				admission.accepted++;
+				accepted++;
+			} catch (const exception& e) {
+				admission.malformed++;
+				cerr << "Error submitting process: " << e.what() << endl;
+			}
+		}
+		return accepted;
+	}
+
+	// Everything admitted but not yet retired; deviceQueue is where a backlog builds
+	// up because only ioDevices.size() I/O jobs can move on per step
+	size_t getBacklog() const {
+		return jobQueue.size() + deviceQueue.size() + realTimeDeviceQueue.size() + readyQueue.size() + realTimeQueue.size();
+	}
+
+	// Counts a submission the server refused to parse (e.g. an overlong line)
+	void recordMalformedSubmission() {
+		admission.submitted++;
+		admission.malformed++;
+	}
+
+	// pending: lines already collected for a batch but not yet submitted
+	bool isAcceptingJobs(size_t pending = 0) const {
+		return getBacklog() + pending < MAX_BACKLOG;
+	}
+
+	bool hasPendingWork() const {
+		return !jobQueue.empty() || !readyQueue.empty() || !realTimeQueue.empty() || !deviceQueue.empty() || !realTimeDeviceQueue.empty();
+	}
+
+	void printStats(ostream& out) const {
+		double uptime = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+		out << "uptime_s: " << uptime << "\n";
+		out << "sim_time: " << clock.getCurrentTime() << "\n";
+		out << "job_queue: " << jobQueue.size() << "\n";
+		out << "ready_queue: " << readyQueue.size() << "\n";
+		out << "device_queue: " << deviceQueue.size() << "\n";
+		out << "realtime_queue: " << realTimeQueue.size() << "\n";
+		out << "realtime_device_queue: " << realTimeDeviceQueue.size() << "\n";
+		out << "backlog: " << getBacklog() << "\n";
+		out << "batches: " << admission.batches << "\n";
+		out << "submitted: " << admission.submitted << "\n";
+		out << "accepted: " << admission.accepted << "\n";
+		out << "rejected: " << admission.rejected << "\n";
+		out << "malformed: " << admission.malformed << "\n";
+		out << "completed: " << retired.completed << "\n";
+		out << "submit_rate_per_s: " << (uptime > 0 ? admission.accepted / uptime : 0) << "\n";
+		out << "completion_rate_per_s: " << (uptime > 0 ? retired.completed / uptime : 0) << "\n";
+		out << "avg_burst: " << (retired.completed > 0 ? (double)retired.totalBurstTime / retired.completed : 0) << "\n";
+		out << "avg_turnaround: " << (retired.completed > 0 ? (double)retired.totalTurnaround / retired.completed : 0) << "\n";
+		out << "max_turnaround: " << retired.maxTurnaround << "\n";
+		out << "avg_queue_latency: " << (retired.completed > 0 ? (double)retired.totalQueueLatency / retired.completed : 0) << "\n";
+		out << "max_queue_latency: " << retired.maxQueueLatency << "\n";
+		out << "rt_admitted: " << realTime.admitted << "\n";
+		out << "rt_rejected: " << realTime.rejected << "\n";
+		out << "rt_completed: " << realTime.completed << "\n";
+		out << "rt_density: " << realTime.density << "\n";
+		out << "deadline_misses: " << realTime.deadlineMisses << "\n";
+		out << "avg_lateness: " << (realTime.completed > 0 ? (double)realTime.totalLateness / realTime.completed : 0) << "\n";
+		out << "max_lateness: " << realTime.maxLateness << "\n";
+#if SCHED_INSTRUMENTATION
+		PhaseStats::instance().print(out);
+#endif
+	}
+
+	void printPhaseStats(ostream& out) const {
+#if SCHED_INSTRUMENTATION
+		out << "#### Phase Stats ####" << endl;
+		PhaseStats::instance().print(out);
+#else
+		(void)out;
+#endif
+	}
+
+	// One pass of allocation, CPU scheduling and deallocation followed by a clock tick
+	void runSchedulingStep() {
+		// Current queue states bfr allocation of resources
+		cout << "#### Queue Status ####" << endl;
+		cout << "Job Queue Size: " << jobQueue.size() << endl;
+		cout << "Ready Queue Size: " << readyQueue.size() << endl;
+		cout << "Device Queue Size: " << deviceQueue.size() << endl;
+
+		// Allocate Resources
+		cout << "Allocating Resources ... " << endl;
+		
+		allocateResources();
+
+		// Current queue states after allocation of resources
+		cout << "#### Queue Status ####" << endl;
+		cout << "Job Queue Size: " << jobQueue.size() << endl;
+		cout << "Ready Queue Size: " << readyQueue.size() << endl;
+		cout << "Device Queue Size: " << deviceQueue.size() << endl;
+		
+		// Real-time processes take precedence over whatever PolicyEngine would pick
+		if (!realTimeQueue.empty()) {
+			cout << "Real-Time Scheduling Phase (EDF) ... " << endl;
+			while (!realTimeQueue.empty()) {
+				deallocateRealTimeProcess(scheduler->runEDF(realTimeQueue));
+			}
+		}
+
+		cout << "CPU Scheduling Phase ... " << endl;
+		
+		// This loop schedules CPU
+		while(!readyQueue.empty()) {
+			
+			policyEngine->chooseSchedulingAlgorithm(readyQueue, 5);
+			cout << "Deallocating Resources from completed processes ... " << endl;
+			deallocateResources();
+		}
+		
+		// Advancing the simulation clock
+		clock.tick();
+
+		if (++steps % PHASE_DUMP_INTERVAL == 0) {
+			printPhaseStats(cout);
+		}
+	}
+
 	void simulateScheduling() {
 		cout << "------------------------------------" << endl;
 		cout << "#### Process Scheduling Started ####" << endl;
 		cout << "------------------------------------" << endl;
 		
-		while(!jobQueue.empty() || !readyQueue.empty() || !deviceQueue.empty()) {
-			// Current queue states bfr allocation of resources
-			cout << "#### Queue Status ####" << endl;
-			cout << "Job Queue Size: " << jobQueue.size() << endl;
-			cout << "Ready Queue Size: " << readyQueue.size() << endl;
-			cout << "Device Queue Size: " << deviceQueue.size() << endl;
-
-			// Allocate Resources
-			cout << "Allocating Resources ... " << endl;
-			
-			allocateResources();
-
-			// Current queue states after allocation of resources
-			cout << "#### Queue Status ####" << endl;
-			cout << "Job Queue Size: " << jobQueue.size() << endl;
-			cout << "Ready Queue Size: " << readyQueue.size() << endl;
-			cout << "Device Queue Size: " << deviceQueue.size() << endl;
-			
-			cout << "CPU Scheduling Phase ... " << endl;
-			
-			// This loop schedules CPU
-			while(!readyQueue.empty()) {
-				
-				policyEngine->chooseSchedulingAlgorithm(readyQueue, 5);
-				cout << "Deallocating Resources from completed processes ... " << endl;
-				deallocateResources();
-			}
-			
-			// Advancing the simulation clock
-			clock.tick();
+		while (hasPendingWork()) {
+			runSchedulingStep();
 		}
+		printPhaseStats(cout);
 		
 		cout << "---------------------------------" << endl;
 		cout << "#### Scheduler Shutting Down ####" << endl;
@@ -0,0 +1,313 @@
+#ifndef SUBMISSIONSERVER_H
+#define SUBMISSIONSERVER_H
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <csignal>
+#include "SimulationManager.h"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+using namespace std;
+
+// Keeps a SimulationManager running and feeds it jobs submitted over a pipe
+// (FIFO or stdin) and/or a Unix-domain socket.
+//
+// Protocol is line based. A job line uses the Program.txt format
+// "ppid burst priority waitingForIO [deadline [period]]"; all complete lines read from a source in
+// one go form a batch. Commands:
+//   STATS     - reply with the scheduler statistics
+//   SHUTDOWN  - finish the pending work and stop
+// Socket clients get "OK accepted=<n> rejected=<m>" back for every batch.
+// While the backlog (jobQueue + deviceQueue + ready queues) is at MAX_BACKLOG the
+// server stops reading, so writers block (backpressure). Lines longer than
+// MAX_LINE_LENGTH are discarded as malformed ("ERR line too long"), and at most
+// MAX_CLIENTS socket clients are served at once, so per-connection memory stays bounded.
+class SubmissionServer {
+private:
+    static volatile sig_atomic_t stopRequested;
+
+    static void handleSignal(int) { stopRequested = 1; }
+
+    static const size_t MAX_LINE_LENGTH = 1024;
+    static const size_t MAX_CLIENTS = 64;
+
+#ifndef _WIN32
+    struct Source {
+        int fd;
+        bool isPipe;        // pipes get no replies; their output goes to cout
+        string buffer;
+        bool eof;           // writer closed; drop the source once buffer is drained
+        bool discarding;    // skipping the rest of an overlong line up to the next newline
+    };
+
+    SimulationManager* simulation;
+    int listenFd;
+    string socketPath;
+    string pipePath;
+    vector<Source> sources;
+    bool running;
+
+    bool openPipeSource() {
+        int fd = (pipePath == "-") ? dup(STDIN_FILENO) : open(pipePath.c_str(), O_RDONLY | O_NONBLOCK);
+        if (fd < 0) {
+            cerr << "Failed to open pipe " << pipePath << ": " << strerror(errno) << endl;
+            return false;
+        }
+        sources.push_back({ fd, true, "", false, false });
+        return true;
+    }
+
+    void reply(const Source& src, const string& text) {
+        if (src.isPipe) {
+            cout << text;
+            return;
+        }
+        size_t sent = 0;
+        while (sent < text.size()) {
+            ssize_t n = send(src.fd, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) return;     // client went away; the read side will notice
+            sent += n;
+        }
+    }
+
+    void rejectOverlongLine(Source& src) {
+        simulation->recordMalformedSubmission();
+        cerr << "Discarded submission line longer than " << MAX_LINE_LENGTH << " bytes" << endl;
+        if (!src.isPipe) reply(src, "ERR line too long\n");
+    }
+
+    void submitBatch(Source& src, vector<string>& batch) {
+        if (batch.empty()) return;
+        int accepted = simulation->submitJobs(batch);
+        int refused = (int)batch.size() - accepted;
+        if (!src.isPipe || refused > 0) {
+            reply(src, "OK accepted=" + to_string(accepted) + " rejected=" + to_string(refused) + "\n");
+        }
+        batch.clear();
+    }
+
+    // Splits the buffered input into complete lines, runs commands and submits the rest as one batch.
+    // Jobs read before a command are submitted first so commands see them. Once the backlog is
+    // full the remaining lines stay buffered until the scheduler has caught up.
+    void processBuffer(Source& src) {
+        vector<string> batch;
+        size_t pos;
+        while ((pos = src.buffer.find('\n')) != string::npos) {
+            if (pos > MAX_LINE_LENGTH) {
+                src.buffer.erase(0, pos + 1);
+                rejectOverlongLine(src);
+                continue;
+            }
+            string line = src.buffer.substr(0, pos);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            bool isCommand = (line == "STATS" || line == "SHUTDOWN");
+            bool isBlank = line.find_first_not_of(" \t") == string::npos || line[0] == '#';
+            if (!isCommand && !isBlank && !simulation->isAcceptingJobs(batch.size())) break;
+
+            src.buffer.erase(0, pos + 1);
+            if (isBlank) continue;
+
+            if (isCommand) submitBatch(src, batch);
+
+            if (line == "STATS") {
+                ostringstream out;
+                simulation->printStats(out);
+                reply(src, out.str() + "END\n");
+            }
+            else if (line == "SHUTDOWN") {
+                running = false;
+                reply(src, "OK shutting down\n");
+            }
+            else {
+                batch.push_back(line);
+            }
+        }
+
+        submitBatch(src, batch);
+    }
+
+    // Appends whatever is available to the source's buffer; marks it eof once the writer is gone
+    void readSource(Source& src) {
+        char chunk[4096];
+        ssize_t n = read(src.fd, chunk, sizeof(chunk));
+        if (n < 0) {
+            if (errno != EAGAIN && errno != EINTR) src.eof = true;
+            return;
+        }
+        if (n == 0) {
+            if (!src.buffer.empty() && src.buffer.back() != '\n') {      // last line without a trailing newline
+                src.buffer.push_back('\n');
+            }
+            src.eof = true;
+            return;
+        }
+        src.buffer.append(chunk, n);
+
+        // Drop the tail of an overlong line, then make sure the partial line can't grow unbounded
+        if (src.discarding) {
+            size_t newline = src.buffer.find('\n');
+            if (newline == string::npos) {
+                src.buffer.clear();
+                return;
+            }
+            src.buffer.erase(0, newline + 1);
+            src.discarding = false;
+        }
+        if (src.buffer.size() > MAX_LINE_LENGTH && src.buffer.find('\n') == string::npos) {
+            src.buffer.clear();
+            src.discarding = true;
+            rejectOverlongLine(src);
+        }
+    }
+
+    size_t clientCount() const {
+        size_t count = 0;
+        for (const auto& src : sources) {
+            if (!src.isPipe) count++;
+        }
+        return count;
+    }
+
+    void acceptClient() {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) return;
+        if (clientCount() >= MAX_CLIENTS) {
+            const char* busy = "ERR too many clients\n";
+            send(fd, busy, strlen(busy), MSG_NOSIGNAL);
+            close(fd);
+            return;
+        }
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        sources.push_back({ fd, false, "", false, false });
+    }
+#endif
+
+public:
+#ifndef _WIN32
+    SubmissionServer(SimulationManager* sim) : simulation(sim), listenFd(-1), running(false) {}
+
+    ~SubmissionServer() {
+        for (auto& src : sources) close(src.fd);
+        if (listenFd >= 0) {
+            close(listenFd);
+            unlink(socketPath.c_str());
+        }
+    }
+
+    bool listenOnSocket(const string& path) {
+        sockaddr_un addr{};
+        if (path.size() >= sizeof(addr.sun_path)) {
+            cerr << "Socket path too long: " << path << endl;
+            return false;
+        }
+        listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listenFd < 0) {
+            cerr << "Failed to create socket: " << strerror(errno) << endl;
+            return false;
+        }
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+        unlink(path.c_str());
+        if (bind(listenFd, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(listenFd, 16) < 0) {
+            cerr << "Failed to listen on " << path << ": " << strerror(errno) << endl;
+            close(listenFd);
+            listenFd = -1;
+            return false;
+        }
+        socketPath = path;
+        return true;
+    }
+
+    // "-" reads from stdin; anything else is opened as a named pipe and reopened whenever its writers go away
+    bool listenOnPipe(const string& path) {
+        pipePath = path;
+        return openPipeSource();
+    }
+
+    void run() {
+        signal(SIGINT, handleSignal);
+        signal(SIGTERM, handleSignal);
+        running = true;
+
+        cout << "------------------------------------" << endl;
+        cout << "#### Scheduler Daemon Started ####" << endl;
+        cout << "------------------------------------" << endl;
+
+        while ((running && !stopRequested) || simulation->hasPendingWork()) {
+            if (stopRequested) running = false;
+
+            vector<pollfd> fds;
+            // Backpressure: leave unread input in the kernel buffers while the backlog is full
+            bool accepting = running && simulation->isAcceptingJobs();
+            if (listenFd >= 0) fds.push_back({ listenFd, (short)(running ? POLLIN : 0), 0 });
+            // Sources at eof are skipped by poll (negative fd) while their buffer drains
+            for (auto& src : sources) fds.push_back({ src.eof ? -1 : src.fd, (short)(accepting ? POLLIN : 0), 0 });
+
+            if (fds.empty() && !simulation->hasPendingWork()) break;      // nothing left to read from
+
+            // Don't block while there is scheduling work to do
+            int timeout = simulation->hasPendingWork() ? 0 : 1000;
+            if (poll(fds.data(), fds.size(), timeout) < 0 && errno != EINTR) {
+                cerr << "poll failed: " << strerror(errno) << endl;
+                break;
+            }
+
+            size_t idx = 0;
+            if (listenFd >= 0) {
+                if (fds[idx].revents & POLLIN) acceptClient();
+                idx++;
+            }
+
+            bool reopenPipe = false;
+            for (size_t i = 0; i < sources.size() && idx < fds.size(); ++idx) {
+                Source& src = sources[i];
+                // Only read more once the buffered lines are consumed, so buffers stay bounded
+                bool drained = src.buffer.find('\n') == string::npos;
+                if (accepting && drained && (fds[idx].revents & (POLLIN | POLLHUP | POLLERR))) {
+                    readSource(src);
+                }
+                if (running) {
+                    processBuffer(src);
+                }
+                if (src.eof && (src.buffer.empty() || !running)) {
+                    reopenPipe = reopenPipe || (sources[i].isPipe && pipePath != "-" && running);
+                    close(sources[i].fd);
+                    sources.erase(sources.begin() + i);
+                }
+                else {
+                    ++i;
+                }
+            }
+            if (reopenPipe) openPipeSource();
+
+            if (simulation->hasPendingWork()) {
+                simulation->runSchedulingStep();
+            }
+        }
+
+        cout << "---------------------------------" << endl;
+        cout << "#### Scheduler Daemon Stopped ####" << endl;
+        cout << "---------------------------------" << endl;
+        simulation->printStats(cout);
+    }
+#else
+    SubmissionServer(SimulationManager*) {}
+    bool listenOnSocket(const string&) { cerr << "Daemon mode requires a POSIX system" << endl; return false; }
+    bool listenOnPipe(const string&) { cerr << "Daemon mode requires a POSIX system" << endl; return false; }
+    void run() {}
+#endif
+};
+
+volatile sig_atomic_t SubmissionServer::stopRequested = 0;
+
+#endif
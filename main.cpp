@@ -1,9 +1,41 @@
 #include "SimulationManager.h"
+#include "SubmissionServer.h"
 #include <iostream>
+#include <string>
 using namespace std;
 
-int main() {
+static void printUsage(const char* prog) {
+    cerr << "Usage: " << prog << " [--daemon [--socket PATH] [--pipe PATH|-]]" << endl;
+}
+
+int main(int argc, char* argv[]) {
     try {
+        bool daemonMode = false;
+        string socketPath, pipePath;
+        for (int i = 1; i < argc; ++i) {
+            string arg = argv[i];
+            if (arg == "--daemon") daemonMode = true;
+            else if (arg == "--socket" && i + 1 < argc) socketPath = argv[++i];
+            else if (arg == "--pipe" && i + 1 < argc) pipePath = argv[++i];
+            else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+
+        if (daemonMode) {
+            cout << "Starting Process Scheduler Daemon...\n" << endl;
+
+            SimulationManager simulation(false);
+            SubmissionServer server(&simulation);
+            if (socketPath.empty() && pipePath.empty()) pipePath = "-";
+            if (!socketPath.empty() && !server.listenOnSocket(socketPath)) return 1;
+            if (!pipePath.empty() && !server.listenOnPipe(pipePath)) return 1;
+
+            server.run();
+            return 0;
+        }
+
         cout << "Starting Process Scheduler Simulation...\n" << endl;
         
         SimulationManager simulation;